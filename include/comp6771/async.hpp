@@ -0,0 +1,66 @@
+// Copyright (c) Christopher Di Bella.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+#ifndef COMP6771_ASYNC_HPP
+#define COMP6771_ASYNC_HPP
+
+#include "comp6771/word_ladder.hpp"
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace word_ladder {
+	// A fixed-size pool of threads running jobs in the order they were posted. Destroying it runs
+	// every job still queued, including searches that are part way through, before joining.
+	class executor {
+	public:
+		explicit executor(std::size_t threads = std::thread::hardware_concurrency());
+		executor(executor const&) = delete;
+		auto operator=(executor const&) -> executor& = delete;
+		~executor();
+
+		auto post(std::function<void()> job) -> void;
+
+	private:
+		auto run(std::stop_token stop) -> void;
+
+		std::mutex mutex_;
+		std::condition_variable_any ready_;
+		std::deque<std::function<void()>> jobs_;
+		std::vector<std::jthread> workers_;
+	};
+
+	// Runs generate on pool without blocking the caller. The search goes to the back of the pool's
+	// queue after every bfs level, so a long search cannot starve short ones posted after it. Every
+	// query in flight probes its bucket of the same length_index, which is built once and kept
+	// alive until the last one finishes. If the search throws (std::bad_alloc, or
+	// std::invalid_argument for a null index), the future rethrows it from get.
+	[[nodiscard]] auto generate_async(std::string const& from,
+	                                  std::string const& to,
+	                                  std::shared_ptr<length_index const> lexicon,
+	                                  search_options const& options,
+	                                  executor& pool) -> std::future<search_result>;
+
+	// Same as above, but calls on_complete on one of the pool's threads instead of filling a future.
+	// If the search throws, on_error is called with the exception instead, usually on one of the
+	// pool's threads too, or on the caller's if the search could not be posted at all. Exactly one
+	// of the two is called, and neither may throw.
+	auto generate_async(std::string const& from,
+	                    std::string const& to,
+	                    std::shared_ptr<length_index const> lexicon,
+	                    search_options const& options,
+	                    executor& pool,
+	                    std::function<void(search_result)> on_complete,
+	                    std::function<void(std::exception_ptr)> on_error) -> void;
+} // namespace word_ladder
+
+#endif // COMP6771_ASYNC_HPP
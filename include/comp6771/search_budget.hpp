@@ -0,0 +1,67 @@
+// Copyright (c) Christopher Di Bella.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+#ifndef COMP6771_SEARCH_BUDGET_HPP
+#define COMP6771_SEARCH_BUDGET_HPP
+
+#include "comp6771/word_ladder.hpp"
+
+#include <chrono>
+#include <cstddef>
+
+namespace word_ladder {
+	// Tracks the search_options of one call to generate, so every engine stops for the same reasons
+	// and reports the same status. options must outlive the budget.
+	class search_budget {
+	public:
+		explicit search_budget(search_options const& options)
+		: options_(options) {}
+
+		// count one more expanded word and report whether the search has to stop
+		auto exhausted() -> bool {
+			if (status_ != search_status::complete) {
+				return true;
+			}
+
+			++expanded_;
+			if (expanded_ > options_.max_expanded) {
+				status_ = search_status::truncated;
+			}
+			else if (options_.stop_token.stop_requested()) {
+				status_ = search_status::cancelled;
+			}
+			// reading the clock costs more than the rest of the checks, so only do it every so often
+			else if (expanded_ % clock_stride == 1
+			         and std::chrono::steady_clock::now() >= options_.deadline)
+			{
+				status_ = search_status::timed_out;
+			}
+			return status_ != search_status::complete;
+		}
+
+		// record a found ladder and report whether it fits; one past max_ladders stops the search,
+		// since only then is a ladder actually left out
+		auto accept_ladder() -> bool {
+			if (ladders_ == options_.max_ladders) {
+				status_ = search_status::truncated;
+				return false;
+			}
+			++ladders_;
+			return true;
+		}
+
+		auto status() const -> search_status {
+			return status_;
+		}
+
+	private:
+		static constexpr auto clock_stride = std::size_t{64};
+
+		search_options const& options_;
+		search_status status_ = search_status::complete;
+		std::size_t expanded_ = 0;
+		std::size_t ladders_ = 0;
+	};
+} // namespace word_ladder
+
+#endif // COMP6771_SEARCH_BUDGET_HPP
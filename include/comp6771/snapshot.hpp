@@ -0,0 +1,91 @@
+// Copyright (c) Christopher Di Bella.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+#ifndef COMP6771_SNAPSHOT_HPP
+#define COMP6771_SNAPSHOT_HPP
+
+#include "comp6771/word_ladder.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+namespace word_ladder {
+	// A prebuilt word graph, mapped read-only from a file written by build_snapshot. Every process
+	// that loads the same file shares its physical pages, and no neighbour has to be recomputed at
+	// startup. The file stores, in host byte order: a header with a version and checksum, a table of
+	// length buckets, one arena holding every word, and per-bucket adjacency lists (CSR) and
+	// connected component labels.
+	class snapshot {
+	public:
+		// Every word of one length. Words are fixed-width and sorted, so a word's index is its rank
+		// in lexicographic order and its adjacency list is sorted the same way.
+		class bucket {
+		public:
+			[[nodiscard]] auto word_length() const -> std::size_t;
+			[[nodiscard]] auto size() const -> std::size_t;
+			[[nodiscard]] auto word(std::uint32_t index) const -> std::string_view;
+			[[nodiscard]] auto index_of(std::string_view word) const -> std::optional<std::uint32_t>;
+			[[nodiscard]] auto neighbours(std::uint32_t index) const -> std::span<std::uint32_t const>;
+			[[nodiscard]] auto component(std::uint32_t index) const -> std::uint32_t;
+
+		private:
+			friend class snapshot;
+
+			std::size_t length_ = 0;
+			std::size_t count_ = 0;
+			char const* words_ = nullptr;
+			std::uint32_t const* adjacency_ = nullptr;
+			std::uint32_t const* edges_ = nullptr;
+			std::uint32_t const* components_ = nullptr;
+		};
+
+		snapshot(snapshot const&) = delete;
+		snapshot(snapshot&& other) noexcept;
+		auto operator=(snapshot const&) -> snapshot& = delete;
+		auto operator=(snapshot&& other) noexcept -> snapshot&;
+		~snapshot();
+
+		[[nodiscard]] auto find_bucket(std::size_t word_length) const -> std::optional<bucket>;
+		[[nodiscard]] auto contains(std::string_view word) const -> bool;
+
+	private:
+		friend auto load_snapshot(std::string const& path) -> snapshot;
+
+		snapshot(void const* data, std::size_t size);
+
+		void const* data_ = nullptr;
+		std::size_t size_ = 0;
+	};
+
+	// Precomputes the neighbour graph of every length bucket in the lexicon and writes it to path.
+	// Each word's adjacency list is exactly what the lexicon's one_hop finds for it, so the graph is
+	// directed wherever a word holds a byte outside a-z; components ignore edge direction.
+	auto build_snapshot(std::unordered_set<std::string> const& lexicon, std::string const& path)
+	   -> void;
+
+	// Maps a file written by build_snapshot. Throws std::runtime_error if the file cannot be mapped,
+	// was written by a different format version, fails its checksum, or holds an adjacency list that
+	// points outside its bucket.
+	[[nodiscard]] auto load_snapshot(std::string const& path) -> snapshot;
+
+	// Same as the lexicon overload of generate, but walks the prebuilt graph instead of probing the
+	// lexicon, and returns early when from and to lie in different components.
+	[[nodiscard]] auto generate(std::string const& from,
+	                            std::string const& to,
+	                            snapshot const& graph) -> std::vector<std::vector<std::string>>;
+
+	// Same as above, but gives up once any limit in options is reached, like the lexicon overload
+	// that takes search_options.
+	[[nodiscard]] auto generate(std::string const& from,
+	                            std::string const& to,
+	                            snapshot const& graph,
+	                            search_options const& options) -> search_result;
+} // namespace word_ladder
+
+#endif // COMP6771_SNAPSHOT_HPP
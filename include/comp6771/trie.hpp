@@ -0,0 +1,61 @@
+// Copyright (c) Christopher Di Bella.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+#ifndef COMP6771_TRIE_HPP
+#define COMP6771_TRIE_HPP
+
+#include "comp6771/word_ladder.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+namespace word_ladder {
+	// A minimised trie (DAWG) over every length bucket of a lexicon. Words of one length share a
+	// root, and any two nodes accepting the same set of suffixes are stored once, so the whole
+	// lexicon usually takes a fraction of the memory of an unordered_set. Neighbours are found by
+	// walking the trie along a word while allowing exactly one substitution, which only visits
+	// branches that lead to a word instead of probing all 25 letters at every position.
+	class word_trie {
+	public:
+		explicit word_trie(std::unordered_set<std::string> const& lexicon);
+
+		[[nodiscard]] auto contains(std::string_view word) const -> bool;
+
+		// Every word one letter away from word, in lexicographic order.
+		[[nodiscard]] auto one_hop(std::string const& word) const -> std::vector<std::string>;
+
+		// Bytes held by the trie, not counting the object itself.
+		[[nodiscard]] auto memory_usage() const -> std::size_t;
+
+	private:
+		auto walk(std::uint32_t node,
+		          std::string const& word,
+		          std::size_t pos,
+		          bool substituted,
+		          std::string& curr_word,
+		          std::vector<std::string>& results) const -> void;
+
+		// node i's outgoing edges are [first_edge_[i], first_edge_[i + 1]), sorted by label
+		std::vector<std::uint32_t> first_edge_;
+		std::vector<char> labels_;
+		std::vector<std::uint32_t> targets_;
+		// root of each length bucket, indexed by word length
+		std::vector<std::uint32_t> roots_;
+	};
+
+	// Same as the lexicon overloads of generate, but neighbours come from walking the trie.
+	[[nodiscard]] auto generate(std::string const& from,
+	                            std::string const& to,
+	                            word_trie const& lexicon) -> std::vector<std::vector<std::string>>;
+
+	[[nodiscard]] auto generate(std::string const& from,
+	                            std::string const& to,
+	                            word_trie const& lexicon,
+	                            search_options const& options) -> search_result;
+} // namespace word_ladder
+
+#endif // COMP6771_TRIE_HPP
@@ -4,6 +4,11 @@
 #ifndef COMP6771_WORD_LADDER_HPP
 #define COMP6771_WORD_LADDER_HPP
 
+#include <chrono>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <stop_token>
 #include <unordered_set>
 #include <string>
 #include <vector>
@@ -19,6 +24,103 @@ namespace word_ladder {
 	                            std::string const& to,
 	                            std::unordered_set<std::string> const& lexicon)
 	   -> std::vector<std::vector<std::string>>;
+
+	// Why a call to generate stopped. Anything other than complete means the ladders returned are
+	// only those found before the search was stopped.
+	enum class search_status { complete, truncated, timed_out, cancelled };
+
+	// Limits on a single call to generate, checked once per word the search expands. The defaults
+	// never stop a search early.
+	struct search_options {
+		std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max();
+		std::stop_token stop_token;
+		// returns at most this many ladders, with search_status::truncated only if there was another
+		std::size_t max_ladders = std::numeric_limits<std::size_t>::max();
+		// stops with search_status::truncated once the bfs and dfs have expanded this many words
+		std::size_t max_expanded = std::numeric_limits<std::size_t>::max();
+	};
+
+	struct search_result {
+		std::vector<std::vector<std::string>> ladders;
+		search_status status = search_status::complete;
+	};
+
+	// Same as generate above, but gives up once any limit in options is reached. Ladders are found
+	// in sorted order, so a search that stops early returns a prefix of the complete result.
+	[[nodiscard]] auto generate(std::string const& from,
+	                            std::string const& to,
+	                            std::unordered_set<std::string> const& lexicon,
+	                            search_options const& options) -> search_result;
+
+	// Every simple ladder (no word repeated) from `from` to `to` at most slack hops longer than the
+	// shortest, shortest first and sorted within each length. A slack of 0 gives the same ladders as
+	// generate. Distances to `to` from a reverse bfs prune any word that cannot finish in time.
+	[[nodiscard]] auto generate_within(std::string const& from,
+	                                   std::string const& to,
+	                                   std::unordered_set<std::string> const& lexicon,
+	                                   std::size_t slack,
+	                                   search_options const& options) -> search_result;
+
+	// The k shortest simple ladders, in the same order as generate_within. Fewer than k are only
+	// returned if that is all there are, or a limit in options stopped the search.
+	[[nodiscard]] auto generate_k_shortest(std::string const& from,
+	                                       std::string const& to,
+	                                       std::unordered_set<std::string> const& lexicon,
+	                                       std::size_t k,
+	                                       search_options const& options) -> search_result;
+
+	// A lexicon split by word length. Building it once lets any number of searches share the one
+	// bucket each of them probes, instead of every search filtering the lexicon itself.
+	class length_index {
+	public:
+		explicit length_index(std::unordered_set<std::string> const& lexicon);
+
+		// Every word of the given length, or an empty set if there are none.
+		[[nodiscard]] auto bucket(std::size_t length) const -> std::unordered_set<std::string> const&;
+
+	private:
+		std::vector<std::unordered_set<std::string>> buckets_;
+	};
+
+	class word_trie;
+	class snapshot;
+
+	// A call to generate that runs one bfs level per step, so a caller can interleave many searches
+	// on the same threads. The index, trie or snapshot is only read, and must outlive the search;
+	// a lexicon is filtered down to the start word's length first.
+	class ladder_search {
+	public:
+		ladder_search(std::string const& from,
+		              std::string const& to,
+		              std::unordered_set<std::string> const& lexicon,
+		              search_options const& options);
+		ladder_search(std::string const& from,
+		              std::string const& to,
+		              length_index const& lexicon,
+		              search_options const& options);
+		ladder_search(std::string const& from,
+		              std::string const& to,
+		              word_trie const& lexicon,
+		              search_options const& options);
+		ladder_search(std::string const& from,
+		              std::string const& to,
+		              snapshot const& graph,
+		              search_options const& options);
+		ladder_search(ladder_search&&) noexcept;
+		auto operator=(ladder_search&&) noexcept -> ladder_search&;
+		~ladder_search();
+
+		// Expands the next bfs level, or once the bfs is over, collects the ladders. Returns false
+		// once there is nothing left to do.
+		[[nodiscard]] auto step() -> bool;
+
+		// The ladders found, once step has returned false.
+		[[nodiscard]] auto result() -> search_result;
+
+	private:
+		struct state;
+		std::unique_ptr<state> state_;
+	};
 } // namespace word_ladder
 
 #endif // COMP6771_WORD_LADDER_HPP
@@ -0,0 +1,141 @@
+// Copyright (c) Christopher Di Bella.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+#include "comp6771/async.hpp"
+
+#include <algorithm>
+#include <coroutine>
+#include <exception>
+#include <stdexcept>
+#include <utility>
+
+namespace word_ladder {
+	namespace {
+		// a coroutine that starts straight away and frees itself once it returns
+		struct detached_task {
+			struct promise_type {
+				auto get_return_object() -> detached_task {
+					return {};
+				}
+				auto initial_suspend() noexcept -> std::suspend_never {
+					return {};
+				}
+				auto final_suspend() noexcept -> std::suspend_never {
+					return {};
+				}
+				auto return_void() -> void {}
+				// run_search hands every error from the search to on_error, so only a throwing
+				// callback gets here, and there is nobody left to tell
+				auto unhandled_exception() -> void {
+					std::terminate();
+				}
+			};
+		};
+
+		// suspends the awaiting coroutine and resumes it from the back of the pool's queue
+		struct reschedule {
+			executor& pool;
+
+			auto await_ready() const noexcept -> bool {
+				return false;
+			}
+			auto await_suspend(std::coroutine_handle<> handle) const -> void {
+				pool.post([handle] { handle.resume(); });
+			}
+			auto await_resume() const noexcept -> void {}
+		};
+
+		// parameters are taken by value so the coroutine frame owns them across suspensions
+		auto run_search(std::string from,
+		                std::string to,
+		                std::shared_ptr<length_index const> lexicon,
+		                search_options options,
+		                executor& pool,
+		                std::function<void(search_result)> on_complete,
+		                std::function<void(std::exception_ptr)> on_error) -> detached_task {
+			auto result = search_result();
+			try {
+				co_await reschedule{pool};
+
+				if (lexicon == nullptr) {
+					throw std::invalid_argument("No length_index to search");
+				}
+				auto search = ladder_search(from, to, *lexicon, options);
+				while (search.step()) {
+					co_await reschedule{pool};
+				}
+				result = search.result();
+			} catch (...) {
+				on_error(std::current_exception());
+				co_return;
+			}
+			on_complete(std::move(result));
+		}
+	} // namespace
+
+	executor::executor(std::size_t threads) {
+		threads = std::max(threads, std::size_t{1});
+		workers_.reserve(threads);
+		for (std::size_t i = 0; i < threads; i++) {
+			workers_.emplace_back([this](std::stop_token stop) { run(stop); });
+		}
+	}
+
+	executor::~executor() {
+		// each jthread requests its own stop and joins, while the queue they drain is still alive
+		workers_.clear();
+	}
+
+	auto executor::post(std::function<void()> job) -> void {
+		{
+			auto lock = std::lock_guard(mutex_);
+			jobs_.push_back(std::move(job));
+		}
+		ready_.notify_one();
+	}
+
+	auto executor::run(std::stop_token stop) -> void {
+		while (true) {
+			auto job = std::function<void()>();
+			{
+				auto lock = std::unique_lock(mutex_);
+				// only leave once the queue is drained, since a suspended search lives in it
+				if (not ready_.wait(lock, stop, [&] { return not jobs_.empty(); })) {
+					return;
+				}
+				job = std::move(jobs_.front());
+				jobs_.pop_front();
+			}
+			job();
+		}
+	}
+
+	auto generate_async(std::string const& from,
+	                    std::string const& to,
+	                    std::shared_ptr<length_index const> lexicon,
+	                    search_options const& options,
+	                    executor& pool) -> std::future<search_result> {
+		auto promise = std::make_shared<std::promise<search_result>>();
+		auto future = promise->get_future();
+		generate_async(
+		   from,
+		   to,
+		   std::move(lexicon),
+		   options,
+		   pool,
+		   [promise](search_result result) { promise->set_value(std::move(result)); },
+		   [promise](std::exception_ptr error) { promise->set_exception(std::move(error)); });
+		return future;
+	}
+
+	auto generate_async(std::string const& from,
+	                    std::string const& to,
+	                    std::shared_ptr<length_index const> lexicon,
+	                    search_options const& options,
+	                    executor& pool,
+	                    std::function<void(search_result)> on_complete,
+	                    std::function<void(std::exception_ptr)> on_error) -> void {
+		run_search(
+		   from, to, std::move(lexicon), options, pool, std::move(on_complete), std::move(on_error));
+	}
+} // namespace word_ladder
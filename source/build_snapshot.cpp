@@ -0,0 +1,27 @@
+// Copyright (c) Christopher Di Bella.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+#include "comp6771/snapshot.hpp"
+#include "comp6771/word_ladder.hpp"
+
+#include <exception>
+#include <iostream>
+
+// Prebuilds the word graph of a lexicon so that services can load_snapshot it at startup instead of
+// recomputing neighbours:
+//     build_snapshot ./test/word_ladder/english.txt english.snapshot
+auto main(int argc, char* argv[]) -> int {
+	if (argc != 3) {
+		std::cerr << "usage: " << argv[0] << " <lexicon> <snapshot>\n";
+		return 1;
+	}
+
+	try {
+		auto const lexicon = word_ladder::read_lexicon(argv[1]);
+		word_ladder::build_snapshot(lexicon, argv[2]);
+		std::cout << "wrote " << lexicon.size() << " words to " << argv[2] << "\n";
+	} catch (std::exception const& e) {
+		std::cerr << argv[0] << ": " << e.what() << "\n";
+		return 1;
+	}
+}
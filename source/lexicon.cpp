@@ -5,6 +5,7 @@
 
 #include <unordered_set>
 #include <fstream>
+#include <iterator>
 #include <stdexcept>
 #include <string>
 
@@ -0,0 +1,511 @@
+// Copyright (c) Christopher Di Bella.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+#include "comp6771/snapshot.hpp"
+#include "comp6771/search_budget.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace word_ladder {
+	namespace {
+		constexpr auto snapshot_magic = std::array<char, 8>{'W', 'L', 'S', 'N', 'A', 'P', '\0', '\0'};
+		// 2: adjacency lists hold one_hop's directed edges
+		constexpr auto snapshot_version = std::uint32_t{2};
+		constexpr auto unvisited = std::numeric_limits<std::uint32_t>::max();
+
+		struct file_header {
+			std::array<char, 8> magic;
+			std::uint32_t version;
+			std::uint32_t bucket_count;
+			std::uint64_t file_size;
+			std::uint64_t checksum;
+		};
+
+		struct bucket_header {
+			std::uint32_t length;
+			std::uint32_t word_count;
+			std::uint64_t edge_count;
+			std::uint64_t words_offset;
+			std::uint64_t adjacency_offset;
+			std::uint64_t edges_offset;
+			std::uint64_t components_offset;
+		};
+
+		// FNV-1a over everything that follows the file header
+		auto checksum(char const* first, char const* last) -> std::uint64_t {
+			auto hash = std::uint64_t{14695981039346656037ULL};
+			for (; first != last; ++first) {
+				hash ^= static_cast<unsigned char>(*first);
+				hash *= 1099511628211ULL;
+			}
+			return hash;
+		}
+
+		// pad the buffer so the next section starts on an 8 byte boundary
+		auto align(std::vector<char>& out) {
+			out.resize((out.size() + 7) & ~std::size_t{7});
+		}
+
+		template<typename T>
+		auto append(std::vector<char>& out, T const* data, std::size_t count) -> std::uint64_t {
+			align(out);
+			auto const offset = out.size();
+			out.resize(offset + count * sizeof(T));
+			if (count != 0) {
+				std::memcpy(out.data() + offset, data, count * sizeof(T));
+			}
+			return offset;
+		}
+
+		// same letters as one_hop substitutes, so both engines agree on what a neighbour is
+		auto substitutable(char c) {
+			return c >= 'a' and c <= 'z';
+		}
+
+		// words that differ only at position i share the key formed by skipping i, so sorting by that
+		// key lines every group of neighbours up next to each other
+		auto bucket_edges(std::vector<std::string> const& words) {
+			auto rows = std::vector<std::vector<std::uint32_t>>(words.size());
+			auto order = std::vector<std::uint32_t>(words.size());
+			auto const length = words.empty() ? std::size_t{0} : words.front().size();
+
+			for (std::size_t i = 0; i < length; i++) {
+				auto const same_key = [&](std::uint32_t a, std::uint32_t b) {
+					auto const& x = words[a];
+					auto const& y = words[b];
+					return x.compare(0, i, y, 0, i) == 0
+					       and x.compare(i + 1, x.npos, y, i + 1, y.npos) == 0;
+				};
+				auto const key_less = [&](std::uint32_t a, std::uint32_t b) {
+					auto const& x = words[a];
+					auto const& y = words[b];
+					if (auto const prefix = x.compare(0, i, y, 0, i); prefix != 0) {
+						return prefix < 0;
+					}
+					return x.compare(i + 1, x.npos, y, i + 1, y.npos) < 0;
+				};
+
+				std::iota(order.begin(), order.end(), std::uint32_t{0});
+				std::sort(order.begin(), order.end(), key_less);
+
+				for (std::size_t first = 0; first < order.size();) {
+					auto last = first + 1;
+					while (last < order.size() and same_key(order[first], order[last])) {
+						++last;
+					}
+					for (auto a = first; a < last; a++) {
+						for (auto b = first; b < last; b++) {
+							auto const u = order[a];
+							auto const v = order[b];
+							// like one_hop, only the letter put in has to be a-z, so a word holding
+							// any other byte can step onto a letter but not back
+							if (u != v and substitutable(words[v][i])) {
+								rows[u].push_back(v);
+							}
+						}
+					}
+					first = last;
+				}
+			}
+
+			for (auto& row : rows) {
+				std::sort(row.begin(), row.end());
+			}
+			return rows;
+		}
+
+		// label the components of the graph with every edge taken both ways, so two words with
+		// different labels can never be joined by a ladder
+		auto label_components(std::vector<std::vector<std::uint32_t>> const& rows) {
+			auto links = rows;
+			for (std::uint32_t u = 0; u < rows.size(); u++) {
+				for (auto const v : rows[u]) {
+					links[v].push_back(u);
+				}
+			}
+
+			auto labels = std::vector<std::uint32_t>(rows.size(), unvisited);
+			auto frontier = std::vector<std::uint32_t>();
+			auto next_label = std::uint32_t{0};
+
+			for (std::uint32_t root = 0; root < rows.size(); root++) {
+				if (labels[root] != unvisited) {
+					continue;
+				}
+				labels[root] = next_label;
+				frontier.push_back(root);
+				while (not frontier.empty()) {
+					auto const u = frontier.back();
+					frontier.pop_back();
+					for (auto const v : links[u]) {
+						if (labels[v] == unvisited) {
+							labels[v] = next_label;
+							frontier.push_back(v);
+						}
+					}
+				}
+				++next_label;
+			}
+			return labels;
+		}
+
+		auto in_bounds(std::uint64_t offset, std::uint64_t bytes, std::size_t size) {
+			return offset % alignof(std::uint32_t) == 0 and offset <= size and bytes <= size - offset;
+		}
+
+		// every adjacency list lies inside the edge array and names a word of the same bucket, so no
+		// search can read past the mapping however the file was produced
+		auto valid_edges(bucket_header const& entry, char const* base) {
+			auto const* adjacency =
+			   reinterpret_cast<std::uint32_t const*>(base + entry.adjacency_offset);
+			auto const* edges = reinterpret_cast<std::uint32_t const*>(base + entry.edges_offset);
+			if (adjacency[0] != 0 or adjacency[entry.word_count] != entry.edge_count) {
+				return false;
+			}
+			for (std::uint32_t i = 0; i < entry.word_count; i++) {
+				if (adjacency[i] > adjacency[i + 1]) {
+					return false;
+				}
+			}
+			return std::all_of(edges, edges + entry.edge_count, [&](std::uint32_t word) {
+				return word < entry.word_count;
+			});
+		}
+
+		// visit the prebuilt graph from `from` in adjacency order, keeping only words that sit on a
+		// shortest ladder, so every branch taken ends at `to`
+		auto dfs(snapshot::bucket const& words,
+		         std::vector<std::uint32_t> const& depth,
+		         std::vector<bool> const& on_ladder,
+		         std::uint32_t from,
+		         std::uint32_t to,
+		         std::vector<std::string>& curr_path,
+		         std::vector<std::vector<std::string>>& results,
+		         search_budget& budget) -> void {
+			if (budget.exhausted()) {
+				return;
+			}
+
+			curr_path.emplace_back(words.word(from));
+			if (from == to) {
+				if (budget.accept_ladder()) {
+					results.push_back(curr_path);
+				}
+			}
+			else {
+				for (auto const next : words.neighbours(from)) {
+					if (on_ladder[next] and depth[next] == depth[from] + 1) {
+						dfs(words, depth, on_ladder, next, to, curr_path, results, budget);
+					}
+				}
+			}
+			curr_path.pop_back();
+		}
+	} // namespace
+
+	auto snapshot::bucket::word_length() const -> std::size_t {
+		return length_;
+	}
+
+	auto snapshot::bucket::size() const -> std::size_t {
+		return count_;
+	}
+
+	auto snapshot::bucket::word(std::uint32_t index) const -> std::string_view {
+		return {words_ + index * length_, length_};
+	}
+
+	auto snapshot::bucket::index_of(std::string_view word) const -> std::optional<std::uint32_t> {
+		if (word.size() != length_) {
+			return std::nullopt;
+		}
+
+		auto first = std::uint32_t{0};
+		auto last = static_cast<std::uint32_t>(count_);
+		while (first < last) {
+			auto const middle = first + (last - first) / 2;
+			auto const order = this->word(middle).compare(word);
+			if (order == 0) {
+				return middle;
+			}
+			if (order < 0) {
+				first = middle + 1;
+			}
+			else {
+				last = middle;
+			}
+		}
+		return std::nullopt;
+	}
+
+	auto snapshot::bucket::neighbours(std::uint32_t index) const -> std::span<std::uint32_t const> {
+		return {edges_ + adjacency_[index], edges_ + adjacency_[index + 1]};
+	}
+
+	auto snapshot::bucket::component(std::uint32_t index) const -> std::uint32_t {
+		return components_[index];
+	}
+
+	snapshot::snapshot(void const* data, std::size_t size)
+	: data_(data)
+	, size_(size) {}
+
+	snapshot::snapshot(snapshot&& other) noexcept
+	: data_(std::exchange(other.data_, nullptr))
+	, size_(std::exchange(other.size_, 0)) {}
+
+	auto snapshot::operator=(snapshot&& other) noexcept -> snapshot& {
+		if (this != &other) {
+			if (data_ != nullptr) {
+				::munmap(const_cast<void*>(data_), size_);
+			}
+			data_ = std::exchange(other.data_, nullptr);
+			size_ = std::exchange(other.size_, 0);
+		}
+		return *this;
+	}
+
+	snapshot::~snapshot() {
+		if (data_ != nullptr) {
+			::munmap(const_cast<void*>(data_), size_);
+		}
+	}
+
+	auto snapshot::find_bucket(std::size_t word_length) const -> std::optional<bucket> {
+		auto const* base = static_cast<char const*>(data_);
+		auto const* header = reinterpret_cast<file_header const*>(base);
+		auto const* table = reinterpret_cast<bucket_header const*>(base + sizeof(file_header));
+
+		for (std::uint32_t i = 0; i < header->bucket_count; i++) {
+			auto const& entry = table[i];
+			if (entry.length == word_length) {
+				auto result = bucket();
+				result.length_ = entry.length;
+				result.count_ = entry.word_count;
+				result.words_ = base + entry.words_offset;
+				result.adjacency_ =
+				   reinterpret_cast<std::uint32_t const*>(base + entry.adjacency_offset);
+				result.edges_ = reinterpret_cast<std::uint32_t const*>(base + entry.edges_offset);
+				result.components_ =
+				   reinterpret_cast<std::uint32_t const*>(base + entry.components_offset);
+				return result;
+			}
+		}
+		return std::nullopt;
+	}
+
+	auto snapshot::contains(std::string_view word) const -> bool {
+		auto const words = find_bucket(word.size());
+		return words and words->index_of(word);
+	}
+
+	auto build_snapshot(std::unordered_set<std::string> const& lexicon, std::string const& path)
+	   -> void {
+		// sorted length buckets, so indices follow lexicographic order
+		auto buckets = std::map<std::size_t, std::vector<std::string>>();
+		for (auto const& word : lexicon) {
+			buckets[word.size()].push_back(word);
+		}
+		for (auto& [length, words] : buckets) {
+			std::sort(words.begin(), words.end());
+		}
+
+		auto table = std::vector<bucket_header>();
+		auto out = std::vector<char>(sizeof(file_header) + buckets.size() * sizeof(bucket_header));
+
+		// word arena: every bucket back to back, each word stored without a terminator
+		for (auto const& [length, words] : buckets) {
+			auto entry = bucket_header();
+			entry.length = static_cast<std::uint32_t>(length);
+			entry.word_count = static_cast<std::uint32_t>(words.size());
+			align(out);
+			entry.words_offset = out.size();
+			for (auto const& word : words) {
+				out.insert(out.end(), word.begin(), word.end());
+			}
+			table.push_back(entry);
+		}
+
+		auto entry = table.begin();
+		for (auto const& [length, words] : buckets) {
+			auto const rows = bucket_edges(words);
+			auto const components = label_components(rows);
+			auto adjacency = std::vector<std::uint32_t>{0};
+			auto edges = std::vector<std::uint32_t>();
+			for (auto const& row : rows) {
+				edges.insert(edges.end(), row.begin(), row.end());
+				adjacency.push_back(static_cast<std::uint32_t>(edges.size()));
+			}
+
+			entry->edge_count = edges.size();
+			entry->adjacency_offset = append(out, adjacency.data(), adjacency.size());
+			entry->edges_offset = append(out, edges.data(), edges.size());
+			entry->components_offset = append(out, components.data(), components.size());
+			++entry;
+		}
+		align(out);
+
+		std::memcpy(out.data() + sizeof(file_header),
+		            table.data(),
+		            table.size() * sizeof(bucket_header));
+		auto header = file_header();
+		header.magic = snapshot_magic;
+		header.version = snapshot_version;
+		header.bucket_count = static_cast<std::uint32_t>(table.size());
+		header.file_size = out.size();
+		header.checksum = checksum(out.data() + sizeof(file_header), out.data() + out.size());
+		std::memcpy(out.data(), &header, sizeof(header));
+
+		auto file = std::ofstream(path, std::ios::binary | std::ios::trunc);
+		if (not file) {
+			throw std::runtime_error("Unable to open file.");
+		}
+		file.write(out.data(), static_cast<std::streamsize>(out.size()));
+		if (not file) {
+			throw std::runtime_error("I/O error while writing");
+		}
+	}
+
+	auto load_snapshot(std::string const& path) -> snapshot {
+		auto const fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+		if (fd == -1) {
+			throw std::runtime_error("Unable to open file.");
+		}
+
+		struct ::stat status = {};
+		if (::fstat(fd, &status) == -1
+		    or static_cast<std::size_t>(status.st_size) < sizeof(file_header))
+		{
+			::close(fd);
+			throw std::runtime_error("Not a word ladder snapshot");
+		}
+
+		auto const size = static_cast<std::size_t>(status.st_size);
+		auto* const data = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+		::close(fd);
+		if (data == MAP_FAILED) {
+			throw std::runtime_error("Unable to map file.");
+		}
+		// owns the mapping from here on, so every throw below unmaps it
+		auto graph = snapshot(data, size);
+
+		auto const* base = static_cast<char const*>(data);
+		auto header = file_header();
+		std::memcpy(&header, base, sizeof(header));
+		if (header.magic != snapshot_magic) {
+			throw std::runtime_error("Not a word ladder snapshot");
+		}
+		if (header.version != snapshot_version) {
+			throw std::runtime_error("Unsupported snapshot version");
+		}
+		if (header.file_size != size
+		    or header.bucket_count > (size - sizeof(file_header)) / sizeof(bucket_header))
+		{
+			throw std::runtime_error("Truncated snapshot");
+		}
+		if (header.checksum != checksum(base + sizeof(file_header), base + size)) {
+			throw std::runtime_error("Snapshot checksum mismatch");
+		}
+
+		auto const* table = reinterpret_cast<bucket_header const*>(base + sizeof(file_header));
+		for (std::uint32_t i = 0; i < header.bucket_count; i++) {
+			auto const& entry = table[i];
+			auto const words = std::uint64_t{entry.word_count};
+			if (entry.words_offset > size or entry.length * words > size - entry.words_offset
+			    or not in_bounds(entry.adjacency_offset, (words + 1) * sizeof(std::uint32_t), size)
+			    or not in_bounds(entry.edges_offset, entry.edge_count * sizeof(std::uint32_t), size)
+			    or not in_bounds(entry.components_offset, words * sizeof(std::uint32_t), size))
+			{
+				throw std::runtime_error("Corrupt snapshot bucket table");
+			}
+			// unvisited marks a word the bfs has not reached, so it cannot be a word's index
+			if (entry.word_count == unvisited or not valid_edges(entry, base)) {
+				throw std::runtime_error("Corrupt snapshot adjacency lists");
+			}
+		}
+		return graph;
+	}
+
+	auto generate(std::string const& from, std::string const& to, snapshot const& graph)
+	   -> std::vector<std::vector<std::string>> {
+		return generate(from, to, graph, search_options()).ladders;
+	}
+
+	auto generate(std::string const& from,
+	              std::string const& to,
+	              snapshot const& graph,
+	              search_options const& options) -> search_result {
+		auto result = search_result();
+		auto budget = search_budget(options);
+		auto const words = graph.find_bucket(from.size());
+		if (not words or to.size() != from.size()) {
+			return result;
+		}
+
+		auto const start = words->index_of(from);
+		auto const dest = words->index_of(to);
+		if (not start or not dest or words->component(*start) != words->component(*dest)) {
+			return result;
+		}
+
+		// bfs one level at a time, stopping after the level that reaches the destination
+		auto depth = std::vector<std::uint32_t>(words->size(), unvisited);
+		auto levels = std::vector<std::vector<std::uint32_t>>{{*start}};
+		depth[*start] = 0;
+		while (depth[*dest] == unvisited and not levels.back().empty()) {
+			auto next_level = std::vector<std::uint32_t>();
+			for (auto const word : levels.back()) {
+				if (budget.exhausted()) {
+					result.status = budget.status();
+					return result;
+				}
+				for (auto const next : words->neighbours(word)) {
+					if (depth[next] == unvisited) {
+						depth[next] = depth[word] + 1;
+						next_level.push_back(next);
+					}
+				}
+			}
+			levels.push_back(std::move(next_level));
+		}
+
+		// edges only run one way when a word holds something other than a-z, so the same component
+		// does not guarantee a ladder
+		if (depth[*dest] == unvisited) {
+			return result;
+		}
+
+		// mark the words that sit on some shortest ladder, deepest level first, following edges
+		// forwards only since the reverse of an edge need not exist
+		auto on_ladder = std::vector<bool>(words->size(), false);
+		on_ladder[*dest] = true;
+		for (auto level = levels.size() - 1; level-- > 0;) {
+			for (auto const word : levels[level]) {
+				auto const neighbours = words->neighbours(word);
+				on_ladder[word] = std::any_of(neighbours.begin(), neighbours.end(), [&](auto next) {
+					return depth[next] == depth[word] + 1 and on_ladder[next];
+				});
+			}
+		}
+
+		auto curr_path = std::vector<std::string>();
+		dfs(*words, depth, on_ladder, *start, *dest, curr_path, result.ladders, budget);
+		result.status = budget.status();
+		return result;
+	}
+} // namespace word_ladder
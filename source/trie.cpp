@@ -0,0 +1,153 @@
+// Copyright (c) Christopher Di Bella.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+#include "comp6771/trie.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace word_ladder {
+	namespace {
+		constexpr auto no_root = std::numeric_limits<std::uint32_t>::max();
+
+		// same letters as the lexicon's one_hop substitutes, so both agree on what a neighbour is
+		auto substitutable(char c) {
+			return c >= 'a' and c <= 'z';
+		}
+
+		// labels come from sorted std::strings, which order their chars as unsigned
+		auto label_less(char a, char b) {
+			return static_cast<unsigned char>(a) < static_cast<unsigned char>(b);
+		}
+
+		// a node's outgoing (label, child) edges, which is all there is to tell two nodes apart
+		using signature = std::vector<std::pair<char, std::uint32_t>>;
+	} // namespace
+
+	// node 0 ends every word and has no edges
+	word_trie::word_trie(std::unordered_set<std::string> const& lexicon)
+	: first_edge_{0, 0} {
+		auto buckets = std::map<std::size_t, std::vector<std::string>>();
+		for (auto const& word : lexicon) {
+			buckets[word.size()].push_back(word);
+		}
+
+		auto nodes = std::map<signature, std::uint32_t>{{signature(), 0}};
+		auto const intern = [&](signature const& edges) {
+			auto const next_node = static_cast<std::uint32_t>(first_edge_.size() - 1);
+			auto [node, inserted] = nodes.emplace(edges, next_node);
+			if (inserted) {
+				for (auto const& [label, target] : edges) {
+					labels_.push_back(label);
+					targets_.push_back(target);
+				}
+				first_edge_.push_back(static_cast<std::uint32_t>(labels_.size()));
+			}
+			return node->second;
+		};
+
+		for (auto& [length, words] : buckets) {
+			std::sort(words.begin(), words.end());
+
+			// ids[w] is the node reached after reading words[w] up to the current depth; built from
+			// the last letter up, so each node is interned only once all of its children have been
+			auto ids = std::vector<std::uint32_t>(words.size(), 0);
+			auto edges = signature();
+			for (auto depth = length; depth-- > 0;) {
+				// sorted words sharing their first `depth` letters are next to each other
+				for (std::size_t first = 0; first < words.size();) {
+					auto last = first + 1;
+					while (last < words.size()
+					       and words[first].compare(0, depth, words[last], 0, depth) == 0)
+					{
+						++last;
+					}
+
+					edges.clear();
+					for (auto w = first; w < last; w++) {
+						if (edges.empty() or edges.back().first != words[w][depth]) {
+							edges.emplace_back(words[w][depth], ids[w]);
+						}
+					}
+					std::fill(ids.begin() + static_cast<std::ptrdiff_t>(first),
+					          ids.begin() + static_cast<std::ptrdiff_t>(last),
+					          intern(edges));
+					first = last;
+				}
+			}
+
+			roots_.resize(std::max(roots_.size(), length + 1), no_root);
+			roots_[length] = ids.front();
+		}
+
+		first_edge_.shrink_to_fit();
+		labels_.shrink_to_fit();
+		targets_.shrink_to_fit();
+	}
+
+	auto word_trie::contains(std::string_view word) const -> bool {
+		if (word.size() >= roots_.size() or roots_[word.size()] == no_root) {
+			return false;
+		}
+
+		auto node = roots_[word.size()];
+		for (auto const letter : word) {
+			auto const first = labels_.begin() + first_edge_[node];
+			auto const last = labels_.begin() + first_edge_[node + 1];
+			auto const edge = std::lower_bound(first, last, letter, label_less);
+			if (edge == last or *edge != letter) {
+				return false;
+			}
+			node = targets_[static_cast<std::size_t>(edge - labels_.begin())];
+		}
+		return true;
+	}
+
+	auto word_trie::one_hop(std::string const& word) const -> std::vector<std::string> {
+		auto results = std::vector<std::string>();
+		if (word.size() < roots_.size() and roots_[word.size()] != no_root) {
+			auto curr_word = word;
+			walk(roots_[word.size()], word, 0, false, curr_word, results);
+		}
+		return results;
+	}
+
+	// follow word's letters down the trie, branching off onto another label at most once; like
+	// one_hop, only the letter put in has to be a-z, not the one it replaces
+	auto word_trie::walk(std::uint32_t node,
+	                     std::string const& word,
+	                     std::size_t pos,
+	                     bool substituted,
+	                     std::string& curr_word,
+	                     std::vector<std::string>& results) const -> void {
+		if (pos == word.size()) {
+			if (substituted) {
+				results.push_back(curr_word);
+			}
+			return;
+		}
+
+		for (auto edge = first_edge_[node]; edge < first_edge_[node + 1]; edge++) {
+			auto const letter = labels_[edge];
+			if (letter == word[pos]) {
+				walk(targets_[edge], word, pos + 1, substituted, curr_word, results);
+			}
+			else if (not substituted and substitutable(letter)) {
+				curr_word[pos] = letter;
+				walk(targets_[edge], word, pos + 1, true, curr_word, results);
+				curr_word[pos] = word[pos];
+			}
+		}
+	}
+
+	auto word_trie::memory_usage() const -> std::size_t {
+		return first_edge_.capacity() * sizeof(std::uint32_t)
+		       + labels_.capacity() * sizeof(char)
+		       + targets_.capacity() * sizeof(std::uint32_t)
+		       + roots_.capacity() * sizeof(std::uint32_t);
+	}
+} // namespace word_ladder
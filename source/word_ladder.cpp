@@ -1,12 +1,21 @@
 #include "comp6771/word_ladder.hpp"
+#include "comp6771/search_budget.hpp"
+#include "comp6771/snapshot.hpp"
+#include "comp6771/trie.hpp"
 #include <bits/types/struct_tm.h>
 #include <unordered_map>
 #include <algorithm>
+#include <chrono>
 #include <cstdio>
 #include <iostream>
+#include <limits>
+#include <memory>
+#include <optional>
 #include <ostream>
 #include <queue>
 #include <string>
+#include <utility>
+#include <variant>
 #include <vector>
 
 // z5232937
@@ -114,6 +123,31 @@ namespace word_ladder {
 		word_map[start] = adjacent_words;
 	}
 
+	// add to word map the words one hop away by walking the trie, so only letters leading to a word
+	// are ever tried; the trie hands them back already sorted
+	auto one_hop(std::unordered_map<std::string, std::vector<std::string>>& word_map,
+	             word_trie const& lex,
+	             std::string const& start) {
+		word_map[start] = lex.one_hop(start);
+	}
+
+	// add to word map the words one hop away by reading the snapshot's prebuilt adjacency list,
+	// which is stored in the same sorted order
+	auto one_hop(std::unordered_map<std::string, std::vector<std::string>>& word_map,
+	             snapshot const& lex,
+	             std::string const& start) {
+		auto& adjacent_words = word_map[start];
+		adjacent_words.clear();
+
+		auto const words = lex.find_bucket(start.size());
+		auto const index = words ? words->index_of(start) : std::nullopt;
+		if (index) {
+			for (auto const next : words->neighbours(*index)) {
+				adjacent_words.emplace_back(words->word(next));
+			}
+		}
+	}
+
 	// check if a seen word has a valid depth to be considered in a ladder
 	auto valid_depth(std::string const& curr_word,
 	                 int const& depth,
@@ -148,7 +182,7 @@ namespace word_ladder {
 
 			// to word found, wrap up bfs
 			if (std::find(set.begin(), set.end(), to) != set.end()) {
-				path_len = hop_level[curr_word];
+				path_len = hop_level[curr_word] + 1;
 
 				// remove words that have already been seen at a higher level
 				for (auto word = set.begin(); word != set.end();) {
@@ -202,14 +236,18 @@ namespace word_ladder {
 	             std::unordered_map<std::string, std::vector<std::string>>& word_map,
 	             std::unordered_map<std::string, int>& hop_level,
 	             int const& depth,
-	             std::unordered_set<std::string> const& lex,
-	             std::unordered_set<std::string>& seen_words) {
+	             auto const& lex,
+	             std::unordered_set<std::string>& seen_words,
+	             search_budget& budget) {
 		while (buckets.size() > 0) {
 			auto curr_word = buckets.front();
 			buckets.pop();
 
 			// check if words are to be removed from the set
 			if (valid_depth(curr_word, depth, hop_level)) {
+				if (budget.exhausted()) {
+					return;
+				}
 				one_hop(word_map, lex, curr_word);
 				auto word_key = word_map.find(curr_word);
 				auto& set = word_key->second;
@@ -233,39 +271,38 @@ namespace word_ladder {
 		}
 	}
 
-	// queue ladders until every key explored or dest word found
-	auto bfs(std::unordered_map<std::string, std::vector<std::string>>& word_map,
-	         std::unordered_map<std::string, int>& hop_level,
-	         std::unordered_set<std::string> const& lex,
-	         std::string const& from,
-	         std::string const& to) {
-		auto buckets = std::queue<std::string>();
-		auto seen_words = std::unordered_set<std::string>();
-		seen_words.emplace(from);
-
-		hop_level[from] = 0;
-		auto path_len = 0;
-		auto prev_word = std::string();
-		// push starting word onto queue
-		buckets.push(from);
-
-		while (buckets.size() > 0) {
-			auto curr_word = buckets.front();
-			buckets.pop();
-
+	// expand every queued word sharing the depth of the word at the front of the queue
+	// returns false once the bfs is over: dest word found and its level finished, or nothing left
+	auto bfs_level(std::unordered_map<std::string, std::vector<std::string>>& word_map,
+	               std::unordered_map<std::string, int>& hop_level,
+	               auto const& lex,
+	               std::string const& to,
+	               std::queue<std::string>& buckets,
+	               std::unordered_set<std::string>& seen_words,
+	               int& path_len,
+	               search_budget& budget) {
+		auto const level = hop_level[buckets.front()];
+
+		while (buckets.size() > 0 and hop_level[buckets.front()] == level) {
 			// if shortest path has been found, end bfs at this level
+			// checked before popping, so end_bfs still sees every word left at this level
 			if (path_len) {
-				end_bfs(buckets, word_map, hop_level, path_len, lex, seen_words);
-				break;
+				end_bfs(buckets, word_map, hop_level, path_len - 1, lex, seen_words, budget);
+				return false;
 			}
 
-			else {
-				// enqueue words one hop away
-				one_hop(word_map, lex, curr_word);
-				path_len = enqueue(word_map, hop_level, curr_word, to, buckets, seen_words);
+			if (budget.exhausted()) {
+				return false;
 			}
+
+			auto curr_word = buckets.front();
+			buckets.pop();
+
+			// enqueue words one hop away
+			one_hop(word_map, lex, curr_word);
+			path_len = enqueue(word_map, hop_level, curr_word, to, buckets, seen_words);
 		}
-		return path_len + 1;
+		return buckets.size() > 0;
 	}
 
 	// dfs through word_map and add all valid paths to results
@@ -273,13 +310,20 @@ namespace word_ladder {
 	         std::string const& from,
 	         std::string const& to,
 	         std::vector<std::string>& curr_path,
-	         std::vector<std::vector<std::string>>& results) {
+	         std::vector<std::vector<std::string>>& results,
+	         search_budget& budget) {
+		if (budget.exhausted()) {
+			return;
+		}
+
 		curr_path.push_back(from);
 		auto l = word_map.find(from);
 
 		// to word found, add path to results path and return
 		if (from == to) {
-			results.push_back(curr_path);
+			if (budget.accept_ladder()) {
+				results.push_back(curr_path);
+			}
 			curr_path.pop_back();
 			return;
 		}
@@ -297,38 +341,338 @@ namespace word_ladder {
 			     word != l->second.end();
 			     word++)
 			{
-				dfs(word_map, *word, to, curr_path, results);
+				dfs(word_map, *word, to, curr_path, results, budget);
 			}
 			curr_path.pop_back();
 		}
 		return;
 	}
 
+	// grow distances to the dest word one level at a time, until every word fewer than depth hops
+	// away has been expanded; frontier holds the words still to expand, in bfs order
+	auto reverse_bfs(std::unordered_map<std::string, std::vector<std::string>>& word_map,
+	                 std::unordered_map<std::string, int>& dist_to,
+	                 std::queue<std::string>& frontier,
+	                 auto const& lex,
+	                 int const& depth,
+	                 search_budget& budget) {
+		while (frontier.size() > 0 and dist_to[frontier.front()] < depth) {
+			if (budget.exhausted()) {
+				return;
+			}
+
+			auto curr_word = frontier.front();
+			frontier.pop();
+			if (word_map.find(curr_word) == word_map.end()) {
+				one_hop(word_map, lex, curr_word);
+			}
+			for (auto const& word : word_map[curr_word]) {
+				if (dist_to.find(word) == dist_to.end()) {
+					dist_to[word] = dist_to[curr_word] + 1;
+					frontier.push(word);
+				}
+			}
+		}
+	}
+
+	// dfs every simple ladder from curr_word to `to` that is exactly length hops long, only taking
+	// words close enough to `to` to still finish in time
+	auto bounded_dfs(std::unordered_map<std::string, std::vector<std::string>>& word_map,
+	                 std::unordered_map<std::string, int> const& dist_to,
+	                 auto const& lex,
+	                 std::string const& curr_word,
+	                 std::string const& to,
+	                 int const& length,
+	                 std::vector<std::string>& curr_path,
+	                 std::unordered_set<std::string>& on_path,
+	                 std::vector<std::vector<std::string>>& results,
+	                 std::size_t const& max_count,
+	                 search_budget& budget) -> void {
+		if (budget.exhausted()) {
+			return;
+		}
+
+		curr_path.push_back(curr_word);
+		auto const hops = static_cast<int>(curr_path.size()) - 1;
+
+		// a ladder stops at the dest word, so shorter ones were already found at their own length
+		if (curr_word == to) {
+			if (hops == length and budget.accept_ladder()) {
+				results.push_back(curr_path);
+			}
+			curr_path.pop_back();
+			return;
+		}
+
+		if (word_map.find(curr_word) == word_map.end()) {
+			one_hop(word_map, lex, curr_word);
+		}
+		on_path.emplace(curr_word);
+		for (auto const& word : word_map[curr_word]) {
+			if (results.size() >= max_count) {
+				break;
+			}
+
+			auto const dist = dist_to.find(word);
+			if (seen(word, on_path) or dist == dist_to.end() or hops + 1 + dist->second > length) {
+				continue;
+			}
+			bounded_dfs(word_map,
+			            dist_to,
+			            lex,
+			            word,
+			            to,
+			            length,
+			            curr_path,
+			            on_path,
+			            results,
+			            max_count,
+			            budget);
+		}
+		on_path.erase(curr_word);
+		curr_path.pop_back();
+	}
+
+	// simple ladders no more than max_slack hops longer than the shortest, shortest first, stopping
+	// once max_count have been found
+	auto alternative_ladders(std::string const& from,
+	                         std::string const& to,
+	                         auto const& lex,
+	                         std::size_t const& max_slack,
+	                         std::size_t const& max_count,
+	                         search_options const& options) {
+		auto word_map = std::unordered_map<std::string, std::vector<std::string>>();
+		auto dist_to = std::unordered_map<std::string, int>();
+		auto frontier = std::queue<std::string>();
+		auto result = search_result();
+		auto budget = search_budget(options);
+
+		// no word of a different length is one hop away
+		if (from.size() != to.size()) {
+			return result;
+		}
+
+		dist_to[to] = 0;
+		frontier.push(to);
+		auto depth = 0;
+		while (dist_to.find(from) == dist_to.end() and frontier.size() > 0
+		       and budget.status() == search_status::complete)
+		{
+			reverse_bfs(word_map, dist_to, frontier, lex, ++depth, budget);
+		}
+
+		auto const shortest = dist_to.find(from);
+		if (shortest != dist_to.end()) {
+			auto curr_path = std::vector<std::string>();
+			auto on_path = std::unordered_set<std::string>();
+
+			for (auto length = shortest->second;
+			     static_cast<std::size_t>(length - shortest->second) <= max_slack
+			     and result.ladders.size() < max_count and budget.status() == search_status::complete;
+			     length++)
+			{
+				// a simple ladder never visits more words than the dest word's component holds
+				if (frontier.size() == 0 and static_cast<std::size_t>(length) >= dist_to.size()) {
+					break;
+				}
+
+				// every word a ladder of this length can pass through is now within reach of dist_to
+				reverse_bfs(word_map, dist_to, frontier, lex, length, budget);
+				bounded_dfs(word_map,
+				            dist_to,
+				            lex,
+				            from,
+				            to,
+				            length,
+				            curr_path,
+				            on_path,
+				            result.ladders,
+				            max_count,
+				            budget);
+			}
+		}
+
+		result.status = budget.status();
+		return result;
+	}
+
 	auto generate(std::string const& from,
 	              std::string const& to,
 	              std::unordered_set<std::string> const& lexicon)
 	   -> std::vector<std::vector<std::string>> {
-		auto const& start_len = from.length();
-		auto lex = std::unordered_set<std::string>();
-		auto word_map = std::unordered_map<std::string, std::vector<std::string>>();
-		auto hop_level = std::unordered_map<std::string, int>();
-		auto results = std::vector<std::vector<std::string>>();
+		return generate(from, to, lexicon, search_options()).ladders;
+	}
+
+	auto generate(std::string const& from,
+	              std::string const& to,
+	              std::unordered_set<std::string> const& lexicon,
+	              search_options const& options) -> search_result {
+		auto search = ladder_search(from, to, lexicon, options);
+		while (search.step()) {
+		}
+		return search.result();
+	}
+
+	auto generate(std::string const& from, std::string const& to, word_trie const& lexicon)
+	   -> std::vector<std::vector<std::string>> {
+		return generate(from, to, lexicon, search_options()).ladders;
+	}
+
+	auto generate(std::string const& from,
+	              std::string const& to,
+	              word_trie const& lexicon,
+	              search_options const& options) -> search_result {
+		auto search = ladder_search(from, to, lexicon, options);
+		while (search.step()) {
+		}
+		return search.result();
+	}
 
+	auto generate_within(std::string const& from,
+	                     std::string const& to,
+	                     std::unordered_set<std::string> const& lexicon,
+	                     std::size_t slack,
+	                     search_options const& options) -> search_result {
+		auto const unlimited = std::numeric_limits<std::size_t>::max();
+		return alternative_ladders(from, to, lexicon, slack, unlimited, options);
+	}
+
+	auto generate_k_shortest(std::string const& from,
+	                         std::string const& to,
+	                         std::unordered_set<std::string> const& lexicon,
+	                         std::size_t k,
+	                         search_options const& options) -> search_result {
+		auto const unlimited = std::numeric_limits<std::size_t>::max();
+		return alternative_ladders(from, to, lexicon, unlimited, k, options);
+	}
+
+	length_index::length_index(std::unordered_set<std::string> const& lexicon) {
+		for (auto const& word : lexicon) {
+			if (word.size() >= buckets_.size()) {
+				buckets_.resize(word.size() + 1);
+			}
+			buckets_[word.size()].emplace(word);
+		}
+	}
+
+	auto length_index::bucket(std::size_t length) const -> std::unordered_set<std::string> const& {
+		static auto const no_words = std::unordered_set<std::string>();
+		return length < buckets_.size() ? buckets_[length] : no_words;
+	}
+
+	struct ladder_search::state {
+		using neighbours =
+		   std::variant<std::unordered_set<std::string> const*, word_trie const*, snapshot const*>;
+
+		state(std::string const& start,
+		      std::string const& dest,
+		      neighbours provider,
+		      search_options const& limits)
+		: from(start)
+		, to(dest)
+		, lex(provider)
+		, options(limits)
+		, budget(options) {
+			seen_words.emplace(from);
+			hop_level[from] = 0;
+			// push starting word onto queue
+			buckets.push(from);
+
+			// no word of a different length is one hop away
+			bfs_done = from.size() != to.size();
+		}
+
+		std::string from;
+		std::string to;
+		// words as long as from, when the search was given a whole lexicon; a smaller set to probe
+		// makes one_hop several times faster than probing every word
+		std::unordered_set<std::string> bucket;
+		neighbours lex;
+		search_options options;
+		search_budget budget;
+
+		std::unordered_map<std::string, std::vector<std::string>> word_map;
+		std::unordered_map<std::string, int> hop_level;
+		std::queue<std::string> buckets;
+		std::unordered_set<std::string> seen_words;
+		int path_len = 0;
+		bool bfs_done = false;
+		bool finished = false;
+		search_result result;
+	};
+
+	ladder_search::ladder_search(std::string const& from,
+	                             std::string const& to,
+	                             std::unordered_set<std::string> const& lexicon,
+	                             search_options const& options)
+	: state_(std::make_unique<state>(from, to, &lexicon, options)) {
+		auto& s = *state_;
 		// filter lexicon by word length
 		for (auto const& word : lexicon) {
-			if (word.length() == start_len) {
-				lex.emplace(word);
-				// std::cout <<  word << "\n";
+			if (word.size() == from.size()) {
+				s.bucket.emplace(word);
 			}
 		}
+		s.lex = &s.bucket;
+	}
+
+	ladder_search::ladder_search(std::string const& from,
+	                             std::string const& to,
+	                             length_index const& lexicon,
+	                             search_options const& options)
+	: state_(std::make_unique<state>(from, to, &lexicon.bucket(from.size()), options)) {}
+
+	ladder_search::ladder_search(std::string const& from,
+	                             std::string const& to,
+	                             word_trie const& lexicon,
+	                             search_options const& options)
+	: state_(std::make_unique<state>(from, to, &lexicon, options)) {}
+
+	ladder_search::ladder_search(std::string const& from,
+	                             std::string const& to,
+	                             snapshot const& graph,
+	                             search_options const& options)
+	: state_(std::make_unique<state>(from, to, &graph, options)) {}
+
+	ladder_search::ladder_search(ladder_search&&) noexcept = default;
+
+	auto ladder_search::operator=(ladder_search&&) noexcept -> ladder_search& = default;
+
+	ladder_search::~ladder_search() = default;
+
+	auto ladder_search::step() -> bool {
+		auto& s = *state_;
+		if (s.finished) {
+			return false;
+		}
+
+		if (not s.bfs_done) {
+			s.bfs_done = not std::visit(
+			   [&s](auto const* lex) {
+				   return bfs_level(s.word_map,
+				                    s.hop_level,
+				                    *lex,
+				                    s.to,
+				                    s.buckets,
+				                    s.seen_words,
+				                    s.path_len,
+				                    s.budget);
+			   },
+			   s.lex);
+			return true;
+		}
+
+		// to word never reached: skip the dfs over everything the bfs explored
+		if (s.budget.status() == search_status::complete and (s.path_len != 0 or s.from == s.to)) {
+			std::vector<std::string> curr_path;
+			dfs(s.word_map, s.from, s.to, curr_path, s.result.ladders, s.budget);
+		}
+		s.result.status = s.budget.status();
+		s.finished = true;
+		return false;
+	}
 
-		auto path_len = bfs(word_map, hop_level, lex, from, to);
-		// std::cout << "Length of shortest path: " << path_len<< std::endl;
-		// std::cout << "Number of words in path: " << path_len+1 << std::endl;
-		(void)path_len;
-		std::vector<std::string> curr_path;
-		dfs(word_map, from, to, curr_path, results);
-		// print_results(results);
-		return results;
+	auto ladder_search::result() -> search_result {
+		return std::move(state_->result);
 	}
 } // namespace word_ladder
@@ -187,6 +187,40 @@ TEST_CASE("fly -> sky", "[Small]") {
 	REQUIRE(pathlen_check(ladders, length));
 }
 
+// small case where a ladder passes through the word queued right after the one that first
+// reaches the destination
+TEST_CASE("but -> fey", "[Small]") {
+	auto const start = std::string("but");
+	auto const dest = std::string("fey");
+
+	CHECK(start != dest);
+	CHECK(std::size(start) == std::size(dest));
+
+	auto const english_lexicon = word_ladder::read_lexicon("./english.txt");
+	auto const ladders = word_ladder::generate(start, dest, english_lexicon);
+
+	auto const length = 4;
+
+	CHECK(std::size(ladders) == 3);
+	CHECK(std::is_sorted(ladders.begin(), ladders.end()));
+
+	// checking if the outputs are right
+	CHECK(std::count(ladders.begin(),
+	                 ladders.end(),
+	                 std::vector<std::string>{start, "bet", "bey", dest})
+	      == 1);
+	CHECK(std::count(ladders.begin(),
+	                 ladders.end(),
+	                 std::vector<std::string>{start, "bet", "fet", dest})
+	      == 1);
+	CHECK(std::count(ladders.begin(),
+	                 ladders.end(),
+	                 std::vector<std::string>{start, "buy", "bey", dest})
+	      == 1);
+
+	REQUIRE(pathlen_check(ladders, length));
+}
+
 // medium case with common words across paths
 TEST_CASE("code -> data", "[Medium]") {
 	auto const start = std::string("code");
@@ -0,0 +1,202 @@
+//
+//  Copyright UNSW Sydney School of Computer Science and Engineering
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "comp6771/async.hpp"
+#include "comp6771/word_ladder.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "catch2/catch.hpp"
+
+// [Async] test cases: every query in flight shares one length_index, and must return exactly what
+// the blocking generate does
+
+auto shared_english() {
+	return std::make_shared<word_ladder::length_index const>(
+	   word_ladder::read_lexicon("./english.txt"));
+}
+
+TEST_CASE("length_index puts every word in its length's bucket", "[Async]") {
+	auto const english_lexicon = word_ladder::read_lexicon("./english.txt");
+	auto const index = word_ladder::length_index(english_lexicon);
+
+	auto words = std::size_t{0};
+	for (auto length = std::size_t{0}; length < 64; length++) {
+		auto const& bucket = index.bucket(length);
+		CHECK(std::all_of(bucket.begin(), bucket.end(), [&](auto const& word) {
+			return word.size() == length and english_lexicon.contains(word);
+		}));
+		words += bucket.size();
+	}
+	CHECK(words == english_lexicon.size());
+	CHECK(index.bucket(1000).empty());
+}
+
+TEST_CASE("async ladders match generate", "[Async]") {
+	auto const english_index = shared_english();
+	auto const english_lexicon = word_ladder::read_lexicon("./english.txt");
+	auto pool = word_ladder::executor(4);
+
+	auto const pairs = std::vector<std::pair<std::string, std::string>>{
+	   {"at", "it"},
+	   {"hat", "him"},
+	   {"code", "data"},
+	   {"work", "play"},
+	   {"yttric", "talons"},
+	};
+
+	auto const options = word_ladder::search_options();
+	auto futures = std::vector<std::future<word_ladder::search_result>>();
+	for (auto const& [start, dest] : pairs) {
+		futures.push_back(word_ladder::generate_async(start, dest, english_index, options, pool));
+	}
+
+	for (std::size_t i = 0; i < pairs.size(); i++) {
+		auto const& [start, dest] = pairs[i];
+		auto const result = futures[i].get();
+		CAPTURE(start, dest);
+		CHECK(result.status == word_ladder::search_status::complete);
+		CHECK(result.ladders == word_ladder::generate(start, dest, english_lexicon));
+	}
+}
+
+TEST_CASE("short queries are not starved by a long one", "[Async]") {
+	auto const english_index = shared_english();
+	auto order = std::vector<std::string>();
+	auto mutex = std::mutex();
+	auto const record = [&](std::string name) {
+		return [&, name](word_ladder::search_result) {
+			auto lock = std::lock_guard(mutex);
+			order.push_back(name);
+		};
+	};
+	auto const fail = [&](std::exception_ptr) {
+		auto lock = std::lock_guard(mutex);
+		order.push_back("error");
+	};
+
+	{
+		// a single thread, so only yielding between bfs levels lets the short query through
+		auto pool = word_ladder::executor(1);
+		auto const options = word_ladder::search_options();
+		auto const& words = english_index;
+		word_ladder::generate_async("atlases", "cabaret", words, options, pool, record("long"), fail);
+		word_ladder::generate_async("hat", "him", words, options, pool, record("short"), fail);
+	}
+
+	CHECK(order == std::vector<std::string>{"short", "long"});
+}
+
+TEST_CASE("errors reach the caller instead of ending the process", "[Async]") {
+	auto pool = word_ladder::executor(2);
+	auto const options = word_ladder::search_options();
+	auto const no_index = std::shared_ptr<word_ladder::length_index const>();
+
+	auto future = word_ladder::generate_async("hat", "him", no_index, options, pool);
+	CHECK_THROWS_AS(future.get(), std::invalid_argument);
+
+	auto error = std::promise<std::exception_ptr>();
+	auto completed = std::atomic<bool>(false);
+	word_ladder::generate_async(
+	   "hat",
+	   "him",
+	   no_index,
+	   options,
+	   pool,
+	   [&](word_ladder::search_result) { completed = true; },
+	   [&](std::exception_ptr e) { error.set_value(e); });
+	auto const thrown = error.get_future().get();
+	REQUIRE(thrown != nullptr);
+	CHECK_THROWS_AS(std::rethrow_exception(thrown), std::invalid_argument);
+	CHECK_FALSE(completed);
+
+	// the pool is still usable afterwards
+	auto result = word_ladder::generate_async("hat", "him", shared_english(), options, pool);
+	CHECK(result.get().status == word_ladder::search_status::complete);
+}
+
+// local load generator: prints throughput and tail latency under concurrency
+TEST_CASE("load generator", "[Async][Load]") {
+	using clock = std::chrono::steady_clock;
+
+	auto const english_index = shared_english();
+	auto const pairs = std::vector<std::pair<std::string, std::string>>{
+	   {"at", "it"},
+	   {"hat", "him"},
+	   {"dog", "mug"},
+	   {"fly", "sky"},
+	   {"code", "data"},
+	   {"code", "good"},
+	   {"work", "play"},
+	   {"yttric", "talons"},
+	};
+	auto const queries = std::size_t{48};
+
+	auto latencies = std::vector<clock::duration>();
+	auto complete = std::size_t{0};
+	auto failed = std::size_t{0};
+	auto mutex = std::mutex();
+	auto const start = clock::now();
+	{
+		auto pool = word_ladder::executor(4);
+		for (std::size_t i = 0; i < queries; i++) {
+			auto const& [from, to] = pairs[i % pairs.size()];
+			auto const submitted = clock::now();
+			word_ladder::generate_async(
+			   from,
+			   to,
+			   english_index,
+			   word_ladder::search_options(),
+			   pool,
+			   [&, submitted](word_ladder::search_result result) {
+				   auto const latency = clock::now() - submitted;
+				   auto lock = std::lock_guard(mutex);
+				   latencies.push_back(latency);
+				   complete += result.status == word_ladder::search_status::complete;
+			   },
+			   [&](std::exception_ptr) {
+				   auto lock = std::lock_guard(mutex);
+				   ++failed;
+			   });
+		}
+	}
+	auto const elapsed = std::chrono::duration<double>(clock::now() - start).count();
+
+	REQUIRE(failed == 0);
+	REQUIRE(latencies.size() == queries);
+	CHECK(complete == queries);
+
+	std::sort(latencies.begin(), latencies.end());
+	auto const percentile = [&](double p) {
+		auto const i = static_cast<std::size_t>(p * static_cast<double>(latencies.size() - 1));
+		return std::chrono::duration<double, std::milli>(latencies[i]).count();
+	};
+	std::cout << "load generator: " << queries << " queries on 4 threads in " << elapsed << " s ("
+	          << static_cast<double>(queries) / elapsed << " queries/s), latency p50 "
+	          << percentile(0.50) << " ms, p99 " << percentile(0.99) << " ms, max "
+	          << percentile(1.0) << " ms\n";
+}
@@ -0,0 +1,123 @@
+//
+//  Copyright UNSW Sydney School of Computer Science and Engineering
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "comp6771/word_ladder.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <stop_token>
+#include <string>
+#include <vector>
+
+#include "catch2/catch.hpp"
+
+// [Options] test cases: the limits in search_options stop a search early and report why, while the
+// defaults leave generate's results untouched
+
+TEST_CASE("default options run to completion", "[Options]") {
+	auto const english_lexicon = word_ladder::read_lexicon("./english.txt");
+	auto const result =
+	   word_ladder::generate("work", "play", english_lexicon, word_ladder::search_options());
+
+	CHECK(result.status == word_ladder::search_status::complete);
+	CHECK(std::size(result.ladders) == 12);
+	CHECK(result.ladders == word_ladder::generate("work", "play", english_lexicon));
+}
+
+TEST_CASE("unreachable words complete with no ladders", "[Options][NonExistent]") {
+	auto const english_lexicon = word_ladder::read_lexicon("./english.txt");
+	auto const result = word_ladder::generate("abbreviating",
+	                                          "woodshedding",
+	                                          english_lexicon,
+	                                          word_ladder::search_options());
+
+	CHECK(result.status == word_ladder::search_status::complete);
+	CHECK(result.ladders.empty());
+}
+
+TEST_CASE("max_ladders truncates to a prefix of the ladders", "[Options][Large]") {
+	auto const english_lexicon = word_ladder::read_lexicon("./english.txt");
+	auto options = word_ladder::search_options();
+	options.max_ladders = 5;
+
+	auto const result = word_ladder::generate("atlases", "cabaret", english_lexicon, options);
+	auto const all = word_ladder::generate("atlases", "cabaret", english_lexicon);
+
+	CHECK(result.status == word_ladder::search_status::truncated);
+	REQUIRE(std::size(result.ladders) == 5);
+	CHECK(std::equal(result.ladders.begin(), result.ladders.end(), all.begin()));
+}
+
+// work -> play has exactly 12 ladders, so only a limit below that leaves one out
+TEST_CASE("max_ladders only truncates when a ladder is left out", "[Options]") {
+	auto const english_lexicon = word_ladder::read_lexicon("./english.txt");
+	auto const all = word_ladder::generate("work", "play", english_lexicon);
+	auto options = word_ladder::search_options();
+
+	options.max_ladders = 12;
+	auto const exact = word_ladder::generate("work", "play", english_lexicon, options);
+	CHECK(exact.status == word_ladder::search_status::complete);
+	CHECK(exact.ladders == all);
+
+	options.max_ladders = 11;
+	auto const short_one = word_ladder::generate("work", "play", english_lexicon, options);
+	CHECK(short_one.status == word_ladder::search_status::truncated);
+	REQUIRE(std::size(short_one.ladders) == 11);
+	CHECK(std::equal(short_one.ladders.begin(), short_one.ladders.end(), all.begin()));
+
+	options.max_ladders = 0;
+	auto const none = word_ladder::generate("work", "play", english_lexicon, options);
+	CHECK(none.status == word_ladder::search_status::truncated);
+	CHECK(none.ladders.empty());
+
+	auto const unreachable =
+	   word_ladder::generate("abbreviating", "woodshedding", english_lexicon, options);
+	CHECK(unreachable.status == word_ladder::search_status::complete);
+}
+
+TEST_CASE("max_expanded truncates the search", "[Options]") {
+	auto const english_lexicon = word_ladder::read_lexicon("./english.txt");
+	auto options = word_ladder::search_options();
+	options.max_expanded = 10;
+
+	auto const result = word_ladder::generate("charge", "comedo", english_lexicon, options);
+
+	CHECK(result.status == word_ladder::search_status::truncated);
+	CHECK(result.ladders.empty());
+}
+
+TEST_CASE("a passed deadline times out", "[Options]") {
+	auto const english_lexicon = word_ladder::read_lexicon("./english.txt");
+	auto options = word_ladder::search_options();
+	options.deadline = std::chrono::steady_clock::now();
+
+	auto const result = word_ladder::generate("atlases", "cabaret", english_lexicon, options);
+
+	CHECK(result.status == word_ladder::search_status::timed_out);
+	CHECK(result.ladders.empty());
+}
+
+TEST_CASE("a requested stop cancels the search", "[Options]") {
+	auto const english_lexicon = word_ladder::read_lexicon("./english.txt");
+	auto source = std::stop_source();
+	auto options = word_ladder::search_options();
+	options.stop_token = source.get_token();
+	source.request_stop();
+
+	auto const result = word_ladder::generate("code", "data", english_lexicon, options);
+
+	CHECK(result.status == word_ladder::search_status::cancelled);
+	CHECK(result.ladders.empty());
+}
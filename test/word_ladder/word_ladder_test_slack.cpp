@@ -0,0 +1,179 @@
+//
+//  Copyright UNSW Sydney School of Computer Science and Engineering
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "comp6771/word_ladder.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <numeric>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "catch2/catch.hpp"
+
+// [Slack] test cases: ladders longer than the shortest, found by generate_within and
+// generate_k_shortest
+
+// helper function to check that every ladder is a simple ladder of the lexicon from start to dest
+auto valid_ladders(auto const& ladders,
+                   std::string const& start,
+                   std::string const& dest,
+                   std::unordered_set<std::string> const& lexicon) {
+	for (auto const& ladder : ladders) {
+		if (ladder.front() != start or ladder.back() != dest) {
+			return false;
+		}
+		if (std::unordered_set<std::string>(ladder.begin(), ladder.end()).size() != ladder.size()) {
+			return false;
+		}
+		for (std::size_t i = 0; i < ladder.size(); i++) {
+			if (not lexicon.contains(ladder[i])) {
+				return false;
+			}
+			if (i > 0) {
+				auto const& prev = ladder[i - 1];
+				auto const& word = ladder[i];
+				auto const changed = std::inner_product(
+				   prev.begin(), prev.end(), word.begin(), 0, std::plus(), std::not_equal_to());
+				if (changed != 1) {
+					return false;
+				}
+			}
+		}
+	}
+	return true;
+}
+
+// shortest first, then lexicographic within each length
+auto length_then_sorted(auto const& ladders) {
+	return std::is_sorted(ladders.begin(), ladders.end(), [](auto const& a, auto const& b) {
+		return a.size() != b.size() ? a.size() < b.size() : a < b;
+	});
+}
+
+TEST_CASE("no slack gives the shortest ladders", "[Slack]") {
+	auto const english_lexicon = word_ladder::read_lexicon("./english.txt");
+	auto const options = word_ladder::search_options();
+
+	for (auto const& [start, dest] : std::vector<std::pair<std::string, std::string>>{
+	        {"hat", "him"},
+	        {"code", "data"},
+	        {"work", "play"},
+	        {"charge", "comedo"},
+	        // generate used to miss a shortest ladder on these, while the reverse bfs found it
+	        {"but", "fey"},
+	        {"doc", "uts"},
+	        {"notch", "pines"},
+	        {"quote", "tophe"},
+	     })
+	{
+		CAPTURE(start, dest);
+		auto const result = word_ladder::generate_within(start, dest, english_lexicon, 0, options);
+		CHECK(result.status == word_ladder::search_status::complete);
+		CHECK(result.ladders == word_ladder::generate(start, dest, english_lexicon));
+	}
+}
+
+TEST_CASE("hat -> him with one step of slack", "[Slack][Small]") {
+	auto const english_lexicon = word_ladder::read_lexicon("./english.txt");
+	auto const options = word_ladder::search_options();
+	auto const result = word_ladder::generate_within("hat", "him", english_lexicon, 1, options);
+
+	CHECK(result.status == word_ladder::search_status::complete);
+	CHECK(std::size(result.ladders) > 2);
+	CHECK(valid_ladders(result.ladders, "hat", "him", english_lexicon));
+	CHECK(length_then_sorted(result.ladders));
+	CHECK(std::all_of(result.ladders.begin(), result.ladders.end(), [](auto const& ladder) {
+		return ladder.size() == 3 or ladder.size() == 4;
+	}));
+	CHECK(std::count(result.ladders.begin(),
+	                 result.ladders.end(),
+	                 std::vector<std::string>{"hat", "had", "hid", "him"})
+	      == 1);
+}
+
+TEST_CASE("code -> data with two steps of slack", "[Slack][Medium]") {
+	auto const english_lexicon = word_ladder::read_lexicon("./english.txt");
+	auto const options = word_ladder::search_options();
+	auto const result = word_ladder::generate_within("code", "data", english_lexicon, 2, options);
+
+	CHECK(result.status == word_ladder::search_status::complete);
+	CHECK(valid_ladders(result.ladders, "code", "data", english_lexicon));
+	CHECK(length_then_sorted(result.ladders));
+	CHECK(result.ladders.back().size() == 7);
+}
+
+TEST_CASE("k shortest ladders are a prefix of the slack ladders", "[Slack][Medium]") {
+	auto const english_lexicon = word_ladder::read_lexicon("./english.txt");
+	auto const options = word_ladder::search_options();
+	auto const within = word_ladder::generate_within("code", "data", english_lexicon, 1, options);
+	auto const k_shortest =
+	   word_ladder::generate_k_shortest("code", "data", english_lexicon, 10, options);
+
+	CHECK(k_shortest.status == word_ladder::search_status::complete);
+	REQUIRE(std::size(k_shortest.ladders) == 10);
+	REQUIRE(std::size(within.ladders) >= 10);
+	CHECK(std::equal(k_shortest.ladders.begin(), k_shortest.ladders.end(), within.ladders.begin()));
+}
+
+TEST_CASE("atlases -> cabaret k shortest past the shortest", "[Slack][Large]") {
+	auto const english_lexicon = word_ladder::read_lexicon("./english.txt");
+	auto const options = word_ladder::search_options();
+	auto const result =
+	   word_ladder::generate_k_shortest("atlases", "cabaret", english_lexicon, 850, options);
+
+	CHECK(result.status == word_ladder::search_status::complete);
+	REQUIRE(std::size(result.ladders) == 850);
+	CHECK(result.ladders[839].size() == 58);
+	CHECK(result.ladders[840].size() == 59);
+	CHECK(length_then_sorted(result.ladders));
+}
+
+TEST_CASE("unreachable words have no alternatives", "[Slack][NonExistent]") {
+	auto const english_lexicon = word_ladder::read_lexicon("./english.txt");
+	auto const options = word_ladder::search_options();
+
+	auto const within =
+	   word_ladder::generate_within("yttric", "talons", english_lexicon, 3, options);
+	CHECK(within.status == word_ladder::search_status::complete);
+	CHECK(within.ladders.empty());
+
+	auto const k_shortest =
+	   word_ladder::generate_k_shortest("atlases", "talons", english_lexicon, 5, options);
+	CHECK(k_shortest.status == word_ladder::search_status::complete);
+	CHECK(k_shortest.ladders.empty());
+}
+
+TEST_CASE("alternative ladders respect search limits", "[Slack][Options]") {
+	auto const english_lexicon = word_ladder::read_lexicon("./english.txt");
+	auto options = word_ladder::search_options();
+	options.max_ladders = 3;
+
+	auto const result = word_ladder::generate_within("code", "data", english_lexicon, 2, options);
+
+	CHECK(result.status == word_ladder::search_status::truncated);
+	CHECK(std::size(result.ladders) == 3);
+
+	// a limit that fits every ladder leaves none out
+	auto const all =
+	   word_ladder::generate_within("hat", "him", english_lexicon, 1, word_ladder::search_options());
+	options.max_ladders = std::size(all.ladders);
+	auto const exact = word_ladder::generate_within("hat", "him", english_lexicon, 1, options);
+	CHECK(exact.status == word_ladder::search_status::complete);
+	CHECK(exact.ladders == all.ladders);
+}
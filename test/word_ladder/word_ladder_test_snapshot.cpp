@@ -0,0 +1,259 @@
+//
+//  Copyright UNSW Sydney School of Computer Science and Engineering
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "comp6771/snapshot.hpp"
+#include "comp6771/word_ladder.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <stop_token>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "catch2/catch.hpp"
+
+// The snapshot is built from the same english.txt as the other tests, so every ladder it returns
+// must match the lexicon overload of generate exactly.
+
+auto english_snapshot() -> word_ladder::snapshot const& {
+	static auto const graph = [] {
+		word_ladder::build_snapshot(word_ladder::read_lexicon("./english.txt"), "./english.snapshot");
+		return word_ladder::load_snapshot("./english.snapshot");
+	}();
+	return graph;
+}
+
+TEST_CASE("snapshot holds every word of the lexicon", "[Snapshot]") {
+	auto const& graph = english_snapshot();
+
+	CHECK(graph.contains("at"));
+	CHECK(graph.contains("cabaret"));
+	CHECK(graph.contains("woodshedding"));
+	CHECK_FALSE(graph.contains("zzzz"));
+	CHECK_FALSE(graph.contains(""));
+
+	auto const words = graph.find_bucket(3);
+	REQUIRE(words);
+	auto const hat = words->index_of("hat");
+	REQUIRE(hat);
+	CHECK(words->word(*hat) == "hat");
+	CHECK(std::is_sorted(words->neighbours(*hat).begin(), words->neighbours(*hat).end()));
+}
+
+TEST_CASE("snapshot ladders match the lexicon", "[Snapshot]") {
+	auto const& graph = english_snapshot();
+	auto const english_lexicon = word_ladder::read_lexicon("./english.txt");
+
+	auto const [start, dest] = GENERATE(table<std::string, std::string>({
+	   {"at", "it"},
+	   {"hat", "him"},
+	   {"dog", "mug"},
+	   {"code", "data"},
+	   {"work", "play"},
+	   {"charge", "comedo"},
+	   {"yttric", "talons"},
+	   {"atlases", "talons"},
+	   // pairs where a shortest ladder runs through the word queued right after the one that first
+	   // reaches dest, which the lexicon overload used to drop
+	   {"but", "fey"},
+	   {"doc", "uts"},
+	   {"notch", "pines"},
+	   {"quote", "tophe"},
+	}));
+
+	CAPTURE(start, dest);
+	auto const ladders = word_ladder::generate(start, dest, graph);
+
+	CHECK(std::is_sorted(ladders.begin(), ladders.end()));
+	CHECK(ladders == word_ladder::generate(start, dest, english_lexicon));
+}
+
+TEST_CASE("ladder_search can take its neighbours from a snapshot", "[Snapshot]") {
+	auto const& graph = english_snapshot();
+
+	auto const [start, dest] = GENERATE(table<std::string, std::string>({
+	   {"at", "it"},
+	   {"but", "fey"},
+	   {"code", "data"},
+	   {"work", "play"},
+	   {"abbreviating", "woodshedding"},
+	}));
+
+	CAPTURE(start, dest);
+	auto search = word_ladder::ladder_search(start, dest, graph, word_ladder::search_options());
+	while (search.step()) {
+	}
+	auto const result = search.result();
+
+	CHECK(result.status == word_ladder::search_status::complete);
+	CHECK(result.ladders == word_ladder::generate(start, dest, graph));
+}
+
+// words holding bytes outside a-z: a letter may replace any of them, but none replaces a letter
+TEST_CASE("snapshot agrees with the lexicon on words that are not all lowercase", "[Snapshot]") {
+	auto const lexicon = std::unordered_set<std::string>{
+	   "a-b", "abb", "acb", "Abb", "aBb", "caf\xc3\xa9", "cafe", "cafes", "caff\xc3\xa9"};
+	word_ladder::build_snapshot(lexicon, "./mixed.snapshot");
+	auto const graph = word_ladder::load_snapshot("./mixed.snapshot");
+
+	auto const words = graph.find_bucket(3);
+	REQUIRE(words);
+	auto const neighbours = [&](std::string const& word) {
+		auto result = std::vector<std::string>();
+		for (auto const next : words->neighbours(*words->index_of(word))) {
+			result.emplace_back(words->word(next));
+		}
+		return result;
+	};
+	CHECK(neighbours("a-b") == std::vector<std::string>{"abb", "acb"});
+	CHECK(neighbours("Abb") == std::vector<std::string>{"abb"});
+	CHECK(neighbours("abb") == std::vector<std::string>{"acb"});
+
+	CHECK(word_ladder::generate("a-b", "acb", graph)
+	      == std::vector<std::vector<std::string>>{{"a-b", "acb"}});
+	CHECK(word_ladder::generate("Abb", "acb", graph)
+	      == std::vector<std::vector<std::string>>{{"Abb", "abb", "acb"}});
+
+	for (auto const& start : lexicon) {
+		for (auto const& dest : lexicon) {
+			if (start == dest or start.size() != dest.size()) {
+				continue;
+			}
+			CAPTURE(start, dest);
+			auto const expected = word_ladder::generate(start, dest, lexicon);
+			CHECK(word_ladder::generate(start, dest, graph) == expected);
+
+			auto search =
+			   word_ladder::ladder_search(start, dest, graph, word_ladder::search_options());
+			while (search.step()) {
+			}
+			CHECK(search.result().ladders == expected);
+		}
+	}
+}
+
+TEST_CASE("atlases -> cabaret from a snapshot", "[Snapshot][Large]") {
+	auto const ladders = word_ladder::generate("atlases", "cabaret", english_snapshot());
+
+	CHECK(std::size(ladders) == 840);
+	CHECK(std::is_sorted(ladders.begin(), ladders.end()));
+	CHECK(ladders.front().size() == 58);
+}
+
+TEST_CASE("snapshot searches respect search limits", "[Snapshot][Options]") {
+	auto const& graph = english_snapshot();
+	auto const all = word_ladder::generate("atlases", "cabaret", graph);
+
+	auto const unlimited =
+	   word_ladder::generate("atlases", "cabaret", graph, word_ladder::search_options());
+	CHECK(unlimited.status == word_ladder::search_status::complete);
+	CHECK(unlimited.ladders == all);
+
+	auto options = word_ladder::search_options();
+	options.max_ladders = 5;
+	auto const truncated = word_ladder::generate("atlases", "cabaret", graph, options);
+	CHECK(truncated.status == word_ladder::search_status::truncated);
+	REQUIRE(std::size(truncated.ladders) == 5);
+	CHECK(std::equal(truncated.ladders.begin(), truncated.ladders.end(), all.begin()));
+
+	options.max_ladders = std::size(all);
+	auto const exact = word_ladder::generate("atlases", "cabaret", graph, options);
+	CHECK(exact.status == word_ladder::search_status::complete);
+	CHECK(exact.ladders == all);
+
+	options = word_ladder::search_options();
+	options.max_expanded = 10;
+	auto const expanded = word_ladder::generate("atlases", "cabaret", graph, options);
+	CHECK(expanded.status == word_ladder::search_status::truncated);
+	CHECK(expanded.ladders.empty());
+
+	options = word_ladder::search_options();
+	options.deadline = std::chrono::steady_clock::now();
+	auto const late = word_ladder::generate("atlases", "cabaret", graph, options);
+	CHECK(late.status == word_ladder::search_status::timed_out);
+	CHECK(late.ladders.empty());
+
+	auto source = std::stop_source();
+	source.request_stop();
+	options = word_ladder::search_options();
+	options.stop_token = source.get_token();
+	auto const cancelled = word_ladder::generate("atlases", "cabaret", graph, options);
+	CHECK(cancelled.status == word_ladder::search_status::cancelled);
+	CHECK(cancelled.ladders.empty());
+}
+
+TEST_CASE("corrupt snapshots are rejected", "[Snapshot]") {
+	(void)english_snapshot();
+
+	CHECK_THROWS_AS(word_ladder::load_snapshot("./missing.snapshot"), std::runtime_error);
+	CHECK_THROWS_AS(word_ladder::load_snapshot("./english.txt"), std::runtime_error);
+
+	auto in = std::ifstream("./english.snapshot", std::ios::binary);
+	auto bytes = std::vector<char>(std::istreambuf_iterator<char>(in), {});
+	REQUIRE(bytes.size() > 64);
+	bytes[bytes.size() / 2] ^= 1;
+	{
+		auto out = std::ofstream("./corrupt.snapshot", std::ios::binary | std::ios::trunc);
+		out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+	}
+	CHECK_THROWS_AS(word_ladder::load_snapshot("./corrupt.snapshot"), std::runtime_error);
+}
+
+// reads a field of the file or bucket header at offset
+template<typename T>
+auto field(std::vector<char> const& bytes, std::size_t offset) {
+	auto value = T();
+	std::memcpy(&value, bytes.data() + offset, sizeof(T));
+	return value;
+}
+
+// a snapshot with a valid checksum can still hold an edge to a word that is not there
+TEST_CASE("snapshots with edges outside their bucket are rejected", "[Snapshot]") {
+	(void)english_snapshot();
+
+	auto in = std::ifstream("./english.snapshot", std::ios::binary);
+	auto bytes = std::vector<char>(std::istreambuf_iterator<char>(in), {});
+
+	// file header: magic, version, bucket count, file size, checksum; 48 byte bucket headers follow
+	auto const bucket_count = field<std::uint32_t>(bytes, 12);
+	auto bucket = std::size_t{32};
+	while (field<std::uint64_t>(bytes, bucket + 8) == 0) {
+		bucket += 48;
+		REQUIRE(bucket < 32 + 48 * std::size_t{bucket_count});
+	}
+	auto const word_count = field<std::uint32_t>(bytes, bucket + 4);
+	auto const edges_offset = field<std::uint64_t>(bytes, bucket + 32);
+	std::memcpy(bytes.data() + edges_offset, &word_count, sizeof(word_count));
+
+	// FNV-1a over everything after the file header, as build_snapshot computes it
+	auto hash = std::uint64_t{14695981039346656037ULL};
+	for (auto i = std::size_t{32}; i < bytes.size(); i++) {
+		hash ^= static_cast<unsigned char>(bytes[i]);
+		hash *= 1099511628211ULL;
+	}
+	std::memcpy(bytes.data() + 24, &hash, sizeof(hash));
+	{
+		auto out = std::ofstream("./bad_edge.snapshot", std::ios::binary | std::ios::trunc);
+		out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+	}
+	CHECK_THROWS_AS(word_ladder::load_snapshot("./bad_edge.snapshot"), std::runtime_error);
+}
@@ -0,0 +1,169 @@
+//
+//  Copyright UNSW Sydney School of Computer Science and Engineering
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "comp6771/trie.hpp"
+#include "comp6771/word_ladder.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "catch2/catch.hpp"
+
+// [Trie] test cases: the trie must agree with the lexicon on every word and every ladder
+
+// what the lexicon's one_hop does: try all 25 other letters at every position
+auto probe_one_hop(std::unordered_set<std::string> const& lexicon, std::string const& start) {
+	auto adjacent_words = std::vector<std::string>();
+	for (std::size_t i = 0; i < start.size(); i++) {
+		for (char alph = 'a'; alph <= 'z'; alph++) {
+			if (alph != start[i]) {
+				auto word = start;
+				word[i] = alph;
+				if (lexicon.contains(word)) {
+					adjacent_words.push_back(word);
+				}
+			}
+		}
+	}
+	std::sort(adjacent_words.begin(), adjacent_words.end());
+	return adjacent_words;
+}
+
+// roughly what an unordered_set<std::string> allocates: its bucket array, one node per word, and
+// the heap buffer of every word too long for the small string optimisation
+auto hash_set_memory(std::unordered_set<std::string> const& lexicon) {
+	auto bytes = lexicon.bucket_count() * sizeof(void*);
+	for (auto const& word : lexicon) {
+		bytes += sizeof(std::string) + 2 * sizeof(void*);
+		if (word.capacity() > std::string().capacity()) {
+			bytes += word.capacity() + 1;
+		}
+	}
+	return bytes;
+}
+
+TEST_CASE("trie holds exactly the lexicon", "[Trie]") {
+	auto const english_lexicon = word_ladder::read_lexicon("./english.txt");
+	auto const trie = word_ladder::word_trie(english_lexicon);
+
+	CHECK(std::all_of(english_lexicon.begin(), english_lexicon.end(), [&](auto const& word) {
+		return trie.contains(word);
+	}));
+	CHECK_FALSE(trie.contains("zzzz"));
+	CHECK_FALSE(trie.contains("ca"));
+	CHECK_FALSE(trie.contains("abbreviatingg"));
+	CHECK(trie.memory_usage() < hash_set_memory(english_lexicon));
+}
+
+TEST_CASE("trie neighbours match probing the lexicon", "[Trie]") {
+	auto const english_lexicon = word_ladder::read_lexicon("./english.txt");
+	auto const trie = word_ladder::word_trie(english_lexicon);
+
+	for (auto const& word : {"at", "hat", "code", "work", "charge", "atlases", "woodshedding"}) {
+		CAPTURE(word);
+		CHECK(trie.one_hop(word) == probe_one_hop(english_lexicon, word));
+	}
+}
+
+// words holding bytes outside a-z, including ones above 0x7f that a signed char sorts first
+TEST_CASE("trie agrees with the lexicon on words that are not all lowercase", "[Trie]") {
+	auto const lexicon = std::unordered_set<std::string>{
+	   "a-b", "aab", "abb", "acb", "aBb", "caf\xc3\xa9", "cafe", "cafes", "caff\xc3\xa9"};
+	auto const trie = word_ladder::word_trie(lexicon);
+
+	for (auto const& word : lexicon) {
+		CAPTURE(word);
+		CHECK(trie.contains(word));
+		CHECK(trie.one_hop(word) == probe_one_hop(lexicon, word));
+	}
+	CHECK_FALSE(trie.contains("caf\xc3\xa8"));
+	CHECK_FALSE(trie.contains("a+b"));
+
+	// a letter may replace the hyphen, but the hyphen never replaces a letter
+	CHECK(trie.one_hop("a-b") == std::vector<std::string>{"aab", "abb", "acb"});
+	CHECK(trie.one_hop("aab") == std::vector<std::string>{"abb", "acb"});
+}
+
+TEST_CASE("trie ladders match the lexicon", "[Trie]") {
+	static auto const english_lexicon = word_ladder::read_lexicon("./english.txt");
+	static auto const trie = word_ladder::word_trie(english_lexicon);
+
+	auto const [start, dest] = GENERATE(table<std::string, std::string>({
+	   {"at", "it"},
+	   {"hat", "him"},
+	   {"code", "data"},
+	   {"work", "play"},
+	   {"charge", "comedo"},
+	   {"yttric", "talons"},
+	   {"atlases", "talons"},
+	}));
+
+	CAPTURE(start, dest);
+	auto const ladders = word_ladder::generate(start, dest, trie);
+
+	CHECK(ladders == word_ladder::generate(start, dest, english_lexicon));
+}
+
+// prints, per word length, the memory of each neighbour provider and the time taken to find the
+// neighbours of (up to the first 2000) words in that length bucket
+TEST_CASE("trie versus lexicon across word lengths", "[Trie][Load]") {
+	using clock = std::chrono::steady_clock;
+
+	auto const english_lexicon = word_ladder::read_lexicon("./english.txt");
+	auto buckets = std::map<std::size_t, std::unordered_set<std::string>>();
+	for (auto const& word : english_lexicon) {
+		buckets[word.size()].insert(word);
+	}
+
+	std::cout << "length  words  hash set KiB  trie KiB  probe ms  trie walk ms\n";
+	for (auto const& [length, words] : buckets) {
+		auto const trie = word_ladder::word_trie(words);
+		auto const sample_size = std::min(words.size(), std::size_t{2000});
+		auto const sample = std::vector<std::string>(
+		   words.begin(), std::next(words.begin(), static_cast<std::ptrdiff_t>(sample_size)));
+
+		auto probed = std::size_t{0};
+		auto const probe_start = clock::now();
+		for (auto const& word : sample) {
+			probed += probe_one_hop(words, word).size();
+		}
+		auto const probe_time = clock::now() - probe_start;
+
+		auto walked = std::size_t{0};
+		auto const walk_start = clock::now();
+		for (auto const& word : sample) {
+			walked += trie.one_hop(word).size();
+		}
+		auto const walk_time = clock::now() - walk_start;
+
+		CHECK(probed == walked);
+
+		auto const ms = [](clock::duration d) {
+			return std::chrono::duration<double, std::milli>(d).count();
+		};
+		std::cout << std::setw(6) << length << std::setw(7) << words.size() << std::setw(14)
+		          << hash_set_memory(words) / 1024 << std::setw(10) << trie.memory_usage() / 1024
+		          << std::setw(10) << std::fixed << std::setprecision(1) << ms(probe_time)
+		          << std::setw(14) << ms(walk_time) << "\n";
+	}
+}